@@ -16,5 +16,7 @@ mkdir -p output dump_files
 # Run samples
 for sample in $(ls sample* | sort -V); do
   echo ${sample}
-  ${ALARA} -v 3 -t output/${sample}.tree ${sample} > output/${sample}.out 2>&1
+  # some samples are intended to end with an error
+  ${ALARA} -v 3 -t output/${sample}.tree ${sample} > output/${sample}.out 2>&1 \
+    || echo "${sample} exited with status $?"
 done
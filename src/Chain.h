@@ -6,6 +6,18 @@
 
 #define INITMAXCHAINLENGTH 25
 
+/* the relative margin kept between a bound on the relative production
+ * and the truncation limits */
+#define REF_BOUND_MARGIN 1e-6
+
+/* the number of scratch matrices and batches of each chain */
+#define NUMSCRATCHT 3
+#define NUMSCRATCHBATCHT 5
+
+/* the number of counters given by getRefCounts(...): the truncation
+ * reference calculations solved and avoided */
+#define NUMREFCOUNTS 2
+
 /** \brief This class stores the information about a particular chain as
  *         the chains are being created and solved.
  *   
@@ -40,6 +52,27 @@ protected:
   /// Flag indicating whether this is a forward or reverse calculation
   static int mode;
 
+  /// The method used to fill the transfer matrices: SOLVER_ADAPTIVE,
+  /// or the order of the Chebyshev rational approximation
+  /// (SOLVER_CRAM16 or SOLVER_CRAM48).
+  static int solver;
+
+  /// The rows of the decay matrices already found, shared by all the
+  /// chains.
+  static DecayCache decayCache;
+
+  /// The elements of the transfer matrices of the truncation reference
+  /// calculations already found, shared by all the chains.
+  static ChainTrie refTrie;
+
+  /// The time from the start of the schedule to the last cooling
+  /// time, or -1 until it is first needed by setState(...).
+  static double refHorizon;
+
+  /// The number of truncation reference calculations solved, and of
+  /// those avoided because refBound() settled the truncation state.
+  static long refSolved, refBounded;
+
   /// A counter which simply tracks the length of the current chain.
   /** By convention, it will always be 1 greater than the rank of the
       bottom isotope in the chain. */
@@ -81,6 +114,18 @@ protected:
       with the fluxes as required. */
   double **rates;
 
+  /// The rows of the table of reaction rates (see RateCache) for the
+  /// flux-dependent rate vectors pointed to by 'rates'.
+  /** The row of the production rate of rank 'rank' is at
+      rateRows[2*rank] and that of its destruction rate at
+      rateRows[2*rank+1], with NULL for a rate vector that is NULL.
+      They are set by foldRates(...) and shared by the thread views of
+      the chain. */
+  double **rateRows;
+
+  /// The length of the storage allocated for 'rateRows'.
+  int rateRowsLen;
+
   /// An array of scalar rates, calculated by collapsing the rate
   /// vectors pointed to by 'rates' with the fluxes of a given 
   /// interval.
@@ -117,6 +162,61 @@ protected:
   /// arrays. This is a simple convenience measure.
   double *l;
  
+  /// The number of intervals whose rates are currently collapsed
+  /// together in 'batchRates'.
+  int nBatch;
+
+  /// The length of the storage allocated for 'batchRates'.
+  int batchRatesLen;
+
+  /// The collapsed flux-dependent rates of a whole block of intervals.
+  /** This is organized as blocks P and d of 'colRates', but with the
+      values of all the intervals of the block stored contiguously for
+      each rate, i.e. P for interval 'b' and index 'idx' of a block P
+      is at batchP[idx*nBatch+b]. */
+  double *batchRates;
+
+  /// These point into 'batchRates' at the beginning of the blocks P
+  /// and d, as P and d do for 'colRates'.
+  double *batchP, *batchD;
+
+  /// A count of the calls to either collapseRates(...), which tells
+  /// whether the rates of a classification are still current.
+  long collapseCode;
+
+  /// The method chosen by classifyRow(...) for each element of the
+  /// new rows of the transfer matrices, for each flux.
+  /** Element 'idx' of the packed matrix of flux 'fluxNum' for
+      interval 'b' is at classMethod[fluxNum*triSize+idx*nBatch+b],
+      where triSize is the size of a packed matrix times the number of
+      intervals. */
+  unsigned char *classMethod;
+
+  /// The production products of the elements of 'classMethod', in the
+  /// same places.
+  double *classProd;
+
+  /// The length of the storage allocated for each of 'classMethod'
+  /// and 'classProd'.
+  int classLen;
+
+  /// The value of 'collapseCode' when each flux was last classified,
+  /// or -1 if it never was.
+  long *classCode;
+
+  /// The number of fluxes in 'classCode'.
+  int classFluxes;
+
+  /// The number of transfer matrix elements filled by each method,
+  /// which is added to the totals of class Statistics when the chain
+  /// is deleted.
+  long methodCtr[NUMMETHODS];
+
+  /// This function classifies the new rows of the transfer matrices of
+  /// a flux once after each collapse of the rates, and returns the
+  /// offset of its classification in 'classMethod' and 'classProd'.
+  int classifyRates(int, int, int, double*, double*);
+
   /// One of two pointers that simply point to truncLimit (ignoreLimit)
   /// or impurityTruncLimit (impurityIgnoreLimit) as appropriate for 
   /// the current chain being solved.
@@ -141,6 +241,71 @@ protected:
   /// flux for truncation calculations.
   Volume *reference;
 
+  /// For a thread view of a chain, this points to the chain being
+  /// viewed, and is NULL otherwise.
+  /** A view shares the topology, the 'rates' and 'loopRank' vectors,
+      and the decay rates L and l of its parent, and owns only the
+      flux-dependent rates P and d. */
+  Chain *parent;
+
+  /// The scratch matrices of this chain.
+  /** Together with 'scratchBatchT' and 'work', these are the arena
+      from which the temporaries of the solution are taken.  Their
+      storage is kept from one use to the next, so that once it has
+      grown to the length of the chain, no further storage is
+      allocated.  Every thread view has its own arena. */
+  Matrix *scratchT;
+
+  /// The scratch batches of matrices of this chain.
+  MatrixBatch *scratchBatchT;
+
+  /// The length of the storage allocated for 'work'.
+  int workLen;
+
+  /// Scratch storage for the exponentials, differences and workspace
+  /// used to fill the matrices.
+  double *work;
+
+  /// This function returns 'work', with room for at least the number
+  /// of values given in the argument.
+  double* getWork(int);
+
+  /// The length of the storage allocated for 'colRates'.
+  int colRatesLen;
+
+  /// The number of thread views in 'views'.
+  int nViews;
+
+  /// The thread views of this chain, which are kept for the life of
+  /// the chain so that their arenas are only filled once.
+  Chain **views;
+
+  /// The storage from which the lists of pointers of pushList(...)
+  /// are taken, as a stack.
+  /** The first slot of each buffer points to the buffer it replaced
+      when it became too small, which is only deleted once all the
+      lists have been released. */
+  void **ptrLists;
+
+  /// The number of slots of 'ptrLists' after the first.
+  int ptrListsLen;
+
+  /// The number of slots of 'ptrLists' in use.
+  int ptrListsTop;
+
+  /// This function makes a thread view consistent with the current
+  /// state of the chain it views.
+  void syncView();
+
+  /// This function fills the argument with the kza value of each
+  /// isotope of the chain, by its rank in the matrices.
+  void matrixKza(double*);
+
+  /// This function returns an upper bound on the relative production
+  /// of the last isotope of the chain in a truncation reference
+  /// calculation, from the rates collapsed with the reference flux.
+  double refBound();
+
   /// This simply indcates the current length of the various arrays
   /// and vectors.
   /** To avoid reallocating space with each change in the
@@ -182,16 +347,43 @@ public:
   /// attached to the stream reference passed in the first argument.
   static void getImpTruncInfo(istream&);
 
+  /// This function reads the method used to fill the transfer
+  /// matrices from the input file attached to the stream reference
+  /// passed in the first argument.
+  static void getSolverInfo(istream&);
+
   /// This function sets 'mode' to the constant defining the 
   /// reverse calculation mode and calls NuclearData::modeReverse().
   static void modeReverse();
 
+  /// This inline function copies the numbers of truncation reference
+  /// calculations solved and avoided into the argument.
+  static void getRefCounts(long *counts)
+    { counts[0] = refSolved; counts[1] = refBounded; };
+
+  /// This inline function adds the numbers of truncation reference
+  /// calculations given in the argument, as from getRefCounts(...),
+  /// to those of the problem.
+  static void accountRefCounts(long *counts)
+    { refSolved += counts[0]; refBounded += counts[1]; };
+
+  /// This function reports the numbers of truncation reference
+  /// calculations solved and avoided.
+  static void reportRefs();
+
   /// Default constructor 
   Chain(Root *newRoot=NULL,topSchedule* top=NULL);
 
   /// The copy constructor 
   Chain(const Chain&);
 
+  /// This constructor creates a thread view of the chain pointed to
+  /// by the argument.
+  /** Several threads can each collapse the rates and solve the
+      schedule for different intervals at once, using their own view
+      of the same chain. */
+  Chain(Chain*);
+
   /// Destructor deletes all the vector storage associated with this
   /// class and the reference volume.
   ~Chain();
@@ -207,20 +399,49 @@ public:
   /// non-flux dependent values.
   void setupColRates();
 
-  /// This function folds the vector rates pointed to by the 'rates'
-  /// vector with the fluxes contained in the VolFlux list and fills
+  /// This function finds the rows of the table of reaction rates
+  /// pointed to by the argument for the rate vectors of this chain,
+  /// folding those that are not yet in the table.
+  void foldRates(RateCache*);
+
+  /// This function looks up the rates of the fluxes contained in the
+  /// VolFlux list in the rows found by foldRates(...) and fills
   /// 'colRates' with the scalar results.
   void collapseRates(VolFlux*);
 
+  /// This function collapses the rates of a whole block of intervals
+  /// at once, given an array of their VolFlux lists and the number
+  /// of intervals in the block, and fills 'batchRates'.
+  void collapseRates(VolFlux**, int);
+
   /// This function is the workhorse of the solution phase.
   void fillTMat(Matrix&, double, int);
 
+  /// This function fills the transfer matrices of all the intervals
+  /// of the block last passed to collapseRates(VolFlux**,int).
+  void fillTMat(Matrix**, double, int);
 
   /// This function multiplies the two lower triangular matrices
   /// specified in the second and third arguments and assigns the 
   /// result to the first argument. 
   void mult(Matrix&, Matrix&, Matrix&);
 
+  /// This function multiplies the single matrix of the second argument
+  /// by each matrix of the third argument, for all the intervals of
+  /// the block last passed to collapseRates(VolFlux**,int).
+  void mult(Matrix**, Matrix&, Matrix**);
+
+  /// This function multiplies the two lower triangular matrices
+  /// specified in the second and third arguments, but only fills the
+  /// vector of the first argument with the elements of the product
+  /// that are tallied, one per rank (see topScheduleT::results(...)).
+  void multResults(double*, Matrix&, Matrix&);
+
+  /// This function does the same as multResults(double*,Matrix&,Matrix&)
+  /// for all the intervals of the block last passed to
+  /// collapseRates(VolFlux**,int).
+  void multResults(double**, Matrix&, Matrix**);
+
   /// This function fills the necessary elements of a decay matrix,
   /// referenced by the first argument, using the decay time of the
   /// second argument.
@@ -240,6 +461,40 @@ public:
 
   /// Inline function provides access to the 'chainLength' variable.
   int getChainLength() { return chainLength; };
+
+  /// Inline function provides access to the 'newRank' variable.
+  int getNewRank() { return newRank; };
+
+  /// Inline function sets the 'newRank' variable, so that the
+  /// transfer matrices of the next solution are found from that rank
+  /// on.
+  void setNewRank(int rank) { newRank = rank; };
+
+  /// Inline function provides access to the 'nBatch' variable.
+  int getBatchSize() { return nBatch; };
+
+  /// This function returns the scratch matrix indexed by the
+  /// argument, which is free for use until the next call to any of
+  /// the functions that fill or multiply matrices.
+  Matrix& getScratch(int);
+
+  /// This function returns the scratch batch indexed by the argument,
+  /// as for getScratch(...).
+  MatrixBatch& getScratchBatch(int);
+
+  /// This function returns a list of thread views of this chain, as
+  /// many as given in the argument, each consistent with its current
+  /// state.
+  Chain** getViews(int);
+
+  /// This function returns storage for a list of as many pointers as
+  /// given in the argument, which must be released with popList(...)
+  /// in the reverse order to that in which it was taken.
+  void** pushList(int);
+
+  /// This function releases the last list of the number of pointers
+  /// given in the argument returned by pushList(...).
+  void popList(int);
 };
 
 #endif
@@ -0,0 +1,140 @@
+/* $Id$ */
+#include "alara.h"
+
+#ifndef CHAINTRIE_H
+#define CHAINTRIE_H
+
+#define TRIE_ROOTS 4096
+/* the number of nodes allocated at once, and the largest number held
+ * before the trie is emptied */
+#define TRIE_BLOCK 4096
+#define TRIE_NODE_LIMIT (1<<18)
+
+/** \brief This class implements a trie of the sub-chains solved by
+ *         the truncation reference calculations of all the roots,
+ *         holding the elements of their transfer matrices.
+ *
+ *  Element (row,col) of a transfer matrix depends only on the
+ *  isotopes from rank 'col' to rank 'row' of the chain, through their
+ *  kza values, destruction rates and production rates, on the
+ *  irradiation time, and on whether it is found by the Bateman method
+ *  or by a loop solution.  The chains of the roots of a problem soon
+ *  reach the same daughters, and every sibling of a node repeats the
+ *  reference calculation of the row of its parent, so the same
+ *  elements are found many times over.
+ *
+ *  Each path of the trie starts at the last isotope of a sub-chain,
+ *  at a root found by a hash of the time, its kza and its destruction
+ *  rate, and steps back through the chain one isotope at a time.  The
+ *  children of a node are matched exactly on the kza, the destruction
+ *  rate and the production rate of the next isotope, so that the
+ *  node reached for column 'col' holds the element (row,col) of every
+ *  chain that follows the same path, for each method that has found
+ *  it.
+ *
+ *  The truncation decisions themselves depend on the whole chain from
+ *  its root isotope, so they are not shared.
+ *
+ *  The nodes are allocated in blocks of TRIE_BLOCK nodes.  Once
+ *  TRIE_NODE_LIMIT nodes are held, the trie is emptied to start
+ *  again.
+ */
+
+class ChainTrie
+{
+ protected:
+
+  /** \brief These objects are the nodes of the trie.
+   */
+  class TrieNode
+    {
+    public:
+      /// The key of this node: the time, kza and destruction rate of
+      /// a root, or the kza, destruction rate and production rate of
+      /// the next isotope for any other node.
+      double key[3];
+
+      /// The element of this path found by the Bateman method (0)
+      /// and by a loop solution (1).
+      double value[2];
+
+      /// Flags indicating which of 'value' have been found.
+      int known[2];
+
+      /// The first child of this node, toward the top of the chain.
+      TrieNode *child;
+
+      /// The next sibling of this node.
+      TrieNode *sibling;
+    };
+
+  /// The roots of the trie, chained through their 'sibling' pointers
+  /// from TRIE_ROOTS buckets.
+  TrieNode **roots;
+
+  /// The blocks from which the nodes are taken, each of TRIE_BLOCK
+  /// nodes, chained through the 'child' pointer of their first node.
+  TrieNode *blocks;
+
+  /// The number of nodes taken from the current block.
+  int blockUsed;
+
+  /// The number of nodes in the trie.
+  int nNodes;
+
+  /// The nodes of the path found by the last call to walk(...), by
+  /// column.
+  TrieNode **path;
+
+  /// The length of the storage allocated for 'path'.
+  int pathLen;
+
+  /// This function returns the child of the node given in the first
+  /// argument, or of the bucket of roots given in the second if it is
+  /// NULL, with the key given in the last three arguments, which is
+  /// added if it is not found.
+  TrieNode* getChild(TrieNode*, TrieNode**, double, double, double);
+
+  /// This function deletes all the nodes of the trie.
+  void clear();
+
+ public:
+  /// Default constructor
+  /** This constructor creates an empty trie. */
+  ChainTrie();
+
+  /// This destructor deletes all the nodes of the trie.
+  ~ChainTrie();
+
+  /// This function finds the path of row 'row' of a transfer matrix,
+  /// adding any nodes that are missing.
+  /** The kza values, production rates and destruction rates of the
+      isotopes of the chain, by rank in the matrix, are given in the
+      second to fourth arguments, and the irradiation time in the
+      last. */
+  void walk(int, double*, double*, double*, double);
+
+  /// This function returns TRUE if the element of the column given in
+  /// the first argument of the last path walked has been found by the
+  /// method given in the second argument, METHOD_BATEMAN or
+  /// METHOD_LOOP, and then sets the last argument to it.
+  int find(int col, int method, double& element)
+    {
+      int slot = (method == METHOD_LOOP);
+      if (!path[col]->known[slot])
+	return FALSE;
+      element = path[col]->value[slot];
+      return TRUE;
+    };
+
+  /// This function stores the element of the column given in the
+  /// first argument of the last path walked, found by the method given
+  /// in the second argument.
+  void store(int col, int method, double element)
+    {
+      int slot = (method == METHOD_LOOP);
+      path[col]->value[slot] = element;
+      path[col]->known[slot] = TRUE;
+    };
+};
+#endif
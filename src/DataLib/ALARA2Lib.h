@@ -0,0 +1,186 @@
+/* $Id$ */
+#include "alara.h"
+
+/* ******* Class Description ************
+
+This class provides access to data libraries which follow the ALARA
+v2 binary library format, and converts ALARA v1 binary libraries to
+this format.  This class is derived directly and publicly from class
+DataLib.
+
+*** Supported Data Library Formats ***
+
+This catalogue of data library types should be included in every new
+module developed to support a new data library format.
+
+                       Input
+Identifier     Value   String   Description
+-------------------------------------------------------------------
+DATALIB_NULL     0     null     A basic DataLib object
+                                (should rarely be used in final object)
+DATALIB_ALARA    1     alara    The default ALARA v1 binary format.
+DATALIB_ASCII    2     ascii    A basic ASCII DataLib object
+                                (should rarely be used in final object)
+DATALIB_EAF      3     eaf      A data library following the formatting
+                                definition of the EAF library (roughly
+                                ENDF/B-6)
+DATALIB_ADJOINT  4     adj      An alara binary library in reversed format
+                                for reverse calculations.
+DATALIB_GAMMA    5     gamma    An alara binary library containing gamma
+                                source information.
+DATALIB_IEAF     6     ieaf     A data library with cross-section
+                                libraries following the GENDF format and
+                                decay/gamma libraries following the
+                                formatting definition of the EAF library
+                                (roughly ENDF/B-6)
+DATALIB_FEIND    7     feind    A FEIND library
+DATALIB_ALARAJOY 8     ajoy     A hybrid data library following the formatting
+                                definition of the FENDL 3.2b (TENDL 2017)
+                                library (TENDL and PENDF format, converted
+                                to GENDF format by an NJOY wrapped Python
+                                preprocessor) for transmutation and the EAF
+                                library for decay.
+DATALIB_ALARA2   9     alara2   The ALARA v2 binary format, with aligned
+                                rate vectors and a hashed index.
+-------------------------------------------------------------------
+
+ *** ALARA v2 Binary Format ***
+
+ The data of the v2 format is stored exactly as it is used by
+ NuclearData, so that an isotope is found with a single probe of a
+ hash index and its data needs no conversion.  The format is:
+
+ * Head (ALARA2HEADSIZE bytes):
+     char[9] magic ALARA2MAGIC
+     int nGroups, int nParents, int hashSize, int nStrings
+     long offset of the string table
+
+ * Index, directly after the head: 'hashSize' slots, a power of 2 at
+   least twice 'nParents', of
+     int kza (ALARA2EMPTY in empty slots), int (unused), long offset
+   An isotope is at the slot given by hashKza(...) or one of the
+   slots following it, probing linearly.
+
+ * Records, each starting on a multiple of ALARA2ALIGN bytes:
+     int kza, int nRxns, double E[3]
+     (nRxns+1) entries of
+       int daughter kza, int emitted string
+     (nRxns+1) rate vectors, each starting on a multiple of
+       ALARA2ALIGN bytes, holding every group followed by the decay
+       rate.
+   The rates are scaled to cm^2, the last vector is the total
+   destruction rate and the last entry has daughter 0 and emitted
+   string -1.
+
+ * String table: 'nStrings' int offsets, relative to the end of the
+   offsets, of the terminated emitted strings that follow them.  Each
+   distinct string is stored once.
+
+ *** Class Members ***
+
+ binLib : FILE*
+    A file pointer for the library itself.
+
+ libPath : char*
+    The full path of a library opened for reading.
+
+ libData : char*
+    The image of the library, created by ALARALib::mapLib(...).
+
+ libSize : long
+    The size of the library image in bytes.
+
+ libMapped : int
+    This flag is set as for ALARALib.
+
+ hashSize : int
+    The number of slots of the hash index.
+
+ hashIdx : const char*
+    A pointer to the hash index in the library image.
+
+ strings : char**
+    The list of emitted strings, pointing into the library image.
+
+ zeroRate : double*
+    A rate vector of zeros, used for the isotopes that are not in the
+    library.
+
+ *** Member Functions ***
+
+ * - Constructors & Destructors - *
+
+ ALARA2Lib(const char*, int)
+    This constructor opens and maps the library with the base name
+    given in the first argument and checks its head.
+
+ ALARA2Lib(const char*, const char*)
+    This constructor converts the ALARA v1 binary library with the
+    base name given in the first argument into an ALARA v2 binary
+    library with the base name given in the second argument.  Each
+    isotope is read with ALARALib::readData(...) into a NuclearData
+    object, whose rate vectors are written out as they are.
+
+ ~ALARA2Lib()
+    The destructor closes the library and releases its image.
+
+ * - Chain - *
+
+ void readData(int, NuclearData*)
+    This is the implementation of the readData interface for the
+    ALARA v2 format.  It finds the record of the KZA value given in
+    the first argument and passes pointers to its rate vectors and
+    emitted strings in the library image to NuclearData::setData(...),
+    called through the object pointed to by the second argument, which
+    uses them in place for the rest of the run.
+
+ * - Utility - *
+
+ static int hashKza(int, int)
+    This function returns the first slot of the hash index, whose size
+    is given in the second argument, to probe for the KZA value given
+    in the first argument.
+
+ */
+
+#ifndef ALARA2LIB_H
+#define ALARA2LIB_H
+
+#define DATALIB_ALARA2 9
+
+#define ALARA2MAGIC "ALARAv2c"
+#define ALARA2HEADSIZE 64
+#define ALARA2ALIGN 64
+#define ALARA2EMPTY -1
+#define ALARA2SLOT (2*SINT+SLONG)
+
+#include "DataLib/DataLib.h"
+
+class ALARA2Lib : public DataLib
+{
+protected:
+  FILE* binLib;
+  char* libPath;
+  char* libData;
+  long libSize;
+  int libMapped;
+
+  int hashSize;
+  const char* hashIdx;
+  char** strings;
+  double* zeroRate;
+
+  static int hashKza(int, int);
+
+public:
+  /* Service */
+  ALARA2Lib(const char*,int setType=DATALIB_ALARA2);
+  ALARA2Lib(const char*, const char*);
+  ~ALARA2Lib();
+
+  /* Chain */
+  void readData(int, NuclearData*);
+
+};
+
+#endif
@@ -39,6 +39,8 @@ DATALIB_ALARAJOY 8     ajoy     A hybrid data library following the formatting
                                 to GENDF format by an NJOY wrapped Python 
                                 preprocessor) for transmutation and the EAF
                                 library for decay.     
+DATALIB_ALARA2   9     alara2   The ALARA v2 binary format, with aligned
+                                rate vectors and a hashed index.
 -------------------------------------------------------------------
 
  *** Locally Defined Classes ***
@@ -70,15 +72,16 @@ DATALIB_ALARAJOY 8     ajoy     A hybrid data library following the formatting
 
     * - Constructors & Destructors - *
 
-    LibIdx(int&,int&,FILE*&)
-       When the final argument is not given, this default constructor
-       sets 'nParents' and 'nGroups' to 0 and the two lists to NULL.
-       Otherwise, it reads the top of the library, finds and jumps to
-       the location of the index, sets 'nParents' and 'nGroups'
-       (second argument passed by reference), creates storage for the
-       two lists of size 'nParents' and parses the file for to fill
-       the lists. 'nParents' and 'nGroups' are sent back to the
-       calling routine through the first two reference arguments.
+    LibIdx(int&,int&,const char*,int&)
+       When the third argument is NULL, this default constructor sets
+       'nParents' and 'nGroups' to 0 and the two lists to NULL.
+       Otherwise, it reads the top of the library image pointed to by
+       the third argument, finds the location of the index, sets
+       'nParents' and 'nGroups' (second argument passed by
+       reference), creates storage for the two lists of size
+       'nParents' and parses the index to fill the lists. 'nParents',
+       'nGroups' and the library type are sent back to the calling
+       routine through the reference arguments.
 
     LibIdx(const LibIdx&)
        The copy constructor does an element-by-element copy of the two
@@ -106,6 +109,10 @@ DATALIB_ALARAJOY 8     ajoy     A hybrid data library following the formatting
        search based on the base ZA number and then scan the
        neighborhood of a match for matching isomeric info.
 
+    int getKza(int)
+       This inline function returns the KZA value of the entry of the
+       index given in the argument.
+
  * END LibIdx DESCRIPTION *
 
  *** Class Members ***
@@ -116,6 +123,23 @@ DATALIB_ALARAJOY 8     ajoy     A hybrid data library following the formatting
  binLib : FILE*
     A file pointer for the library itself.
 
+ libData : char*
+    The image of a library opened for reading.  The library is mapped
+    into memory once, when it is opened, and all the data is read
+    directly from this image rather than with many small reads.  If
+    the library cannot be mapped, the whole file is read into memory.
+
+ libSize : long
+    The size of the library image in bytes.
+
+ libMapped : int
+    This flag is 1 if 'libData' is a memory mapping, 0 if it was read
+    into the free store and -1 if it belongs to another object.
+
+ libPath : char*
+    The full path of a library opened for reading, used to reopen it
+    in a worker process.  It is NULL for a library being created.
+
  
  *** Member Functions ***
 
@@ -134,7 +158,8 @@ DATALIB_ALARAJOY 8     ajoy     A hybrid data library following the formatting
     the file pointer and creates a new index from this file.
  
  ~ALARALib()
-    The destructor closes the library and deletes the index.
+    The destructor closes the library, releases its image and deletes
+    the index.
 
  ALARALib& operator=(const ALARALib&)
     The correct implementation of this operator must ensure that
@@ -142,15 +167,42 @@ DATALIB_ALARAJOY 8     ajoy     A hybrid data library following the formatting
     allocating new space into which to copy the object.
 
      
+ void reopen()
+    When this library was opened for reading, this function reopens
+    'libPath' so that the calling process has its own file position.
+    The image of the library is shared with the parent process and
+    needs no attention.
+
+ static char* mapLib(FILE*, const char*, long&, int&)
+    This function creates and returns the image of the library opened
+    as the first argument, whose path is given in the second
+    argument, and sets its size and the 'libMapped' flag in the last
+    two arguments.  It is shared with class ALARA2Lib.
+
+ static void unmapLib(char*, long, int)
+    This function releases an image created by mapLib(...), given its
+    size and 'libMapped' flag.
+
+ static void getMapped(void*, const char*&, int)
+    This function copies the number of bytes given by the last
+    argument from the library image at the position given in the
+    second argument to the location given in the first argument and
+    advances the position.  The copy avoids misaligned access to
+    values that are packed in the library.
+
  * - Chain - *
 
  void readData(int, NuclearData*)
     This is the implementation of the readData interface for the
     ALARALib library format.  It searches the 'idx' for the KZA value
-    given in the first argument.  It then reads all the data into
-    local variables and passes those to NuclearData::setData(...)
-    called through the object pointed to by the second argument.  If
-    no data is found, it calles NuclearData::setNoData().
+    given in the first argument.  It then parses the record from the
+    library image and passes it to NuclearData::setData(...) called
+    through the object pointed to by the second argument.  The
+    cross-sections are passed as pointers straight into the image,
+    except for those that have trailing zero groups trimmed from the
+    library, or that are misaligned, which are expanded into a single
+    block of local storage.  If no data is found, it calles
+    NuclearData::setNoData().
 
  */
 
@@ -175,7 +227,7 @@ protected:
       
     public:
       /* Service */
-      LibIdx(int& nPar,int& nGroups, FILE*&,int&);
+      LibIdx(int& nPar,int& nGroups, const char*,int&);
       LibIdx(const LibIdx&);
       ~LibIdx()
 	{ delete kza; delete offset; };
@@ -184,13 +236,25 @@ protected:
 
       /* Utility */
       long search(int, int min=0, int max=-1);
+      int getKza(int parNum) { return kza[parNum]; };
 
     } *idx;
 
   FILE* binLib;
+  char* libPath;
+  char* libData;
+  long libSize;
+  int libMapped;
   fstream tmpIdx;
   long offset;
 
+  static char* mapLib(FILE*, const char*, long&, int&);
+  static void unmapLib(char*, long, int);
+  static void getMapped(void* dest, const char*& src, int len)
+    { memcpy(dest,src,len); src += len; };
+
+
+  friend class ALARA2Lib;
 
 public:
   /* Service */
@@ -202,6 +266,7 @@ public:
   ALARALib& operator=(const ALARALib&);
 
   void close(int,int,char*);
+  void reopen();
       
   /* Chain */
   void readData(int, NuclearData*);
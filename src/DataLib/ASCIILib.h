@@ -42,6 +42,8 @@ DATALIB_ALARAJOY 8     ajoy     A hybrid data library following the formatting
                                 to GENDF format by an NJOY wrapped Python 
                                 preprocessor) for transmutation and the EAF
                                 library for decay.     
+DATALIB_ALARA2   9     alara2   The ALARA v2 binary format, with aligned
+                                rate vectors and a hashed index.
 -------------------------------------------------------------------
 
  *** Class Members ***
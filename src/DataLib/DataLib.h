@@ -42,6 +42,8 @@
                                     to GENDF format by an NJOY wrapped Python 
                                     preprocessor) for transmutation and the EAF
                                     library for decay.    
+    DATALIB_ALARA2   9     alara2   The ALARA v2 binary format, with aligned
+                                    rate vectors and a hashed index.
     -------------------------------------------------------------------
     */
     
@@ -54,8 +56,17 @@
 #define EAF2ALARA 301
 #define IEAF2ALARA 601
 #define ALARA2ADJ 104
+#define ALARA2ALARA2 109
 #define ALARAJOY2ALARA 801
 
+/* the longest library cache directory, leaving room in the file name
+ * buffers of the libraries for the names of its entries */
+#define LIBCACHE_DIR_MAX 200
+
+/* the version of the converted libraries in the library cache, which
+ * must be increased whenever the conversion or a library format changes */
+#define LIBCACHE_VERSION 1
+
 #include "NuclearData.h"
 #include "GammaSrc.h"
 
@@ -87,12 +98,24 @@ protected:
   /// library type as described in the catalogue above.
   static int convertLibType(char*);
 
+  /// This function returns the base name, in the cache directory, of
+  /// the conversion of the libraries named in the last two arguments
+  /// from the type given in the first argument, or NULL if there is no
+  /// cache.
+  /** The name is made from a hash of the type and of the contents of
+      the files, which include the group structure. */
+  static char* libCacheName(int, const char*, const char*);
+
 public:
   /// Although not formally a constructor, this function acts as one.
   static DataLib* newLib(char*,istream&);
 
-  // NEED COMMENT
-  static void convertLib(char*, int,istream&);
+  /// This function converts a library given in the input to an ALARA
+  /// binary library and returns the base name of the new library.
+  /** When a cache directory is given by the ALARA_LIBCACHE environment
+      variable, a library converted before from the same files is
+      reused from the cache, and a new conversion is stored in it. */
+  static char* convertLib(char*, int,istream&);
 
   // NEED COMMENT
   static void convertLib(istream&);
@@ -109,6 +132,10 @@ public:
   int getNumGroups()
     { return nGroups; };
 
+  /// This inline function provides read access to the 'nParents' member.
+  int getNumParents()
+    { return nParents; };
+
   /// This defines the interface function readData(...) to the hierarchy
   /// of DataLib classes.
   virtual void readData(int,NuclearData*);
@@ -116,6 +143,14 @@ public:
   // NEED COMMENT
   virtual void readGammaData(int, GammaSrc*);
 
+  /// This function gives the calling process its own connection to
+  /// the library.
+  /** It is called by each worker process in a parallel solution so
+      that file positions are not shared with the parent or with
+      other workers.  Libraries held entirely in memory need not
+      override it. */
+  virtual void reopen() {};
+
 };
 
 
@@ -0,0 +1,150 @@
+/* $Id$ */
+#include "alara.h"
+
+#ifndef DECAYCACHE_H
+#define DECAYCACHE_H
+
+#define DECAY_CACHE_SIZE 1024
+/* the largest number of values held before the table is emptied */
+#define DECAY_CACHE_LIMIT (1<<21)
+/* the number of counters given by getCounts(...): hits and misses */
+#define NUMDECAYCOUNTS 2
+
+/** \brief This class implements a table of the rows of the decay
+ *         matrices, shared by all the chains of all the roots.
+ *
+ *  Element (row,col) of a decay matrix that is found by the Bateman
+ *  method depends only on the isotopes from rank 'col' to rank 'row'
+ *  of the chain, through their decay constants and the branching of
+ *  each into the next, and on the decay time.  Many roots lead to the
+ *  same decay tails, so the elements of a row found for one chain can
+ *  be used for any later chain whose isotopes end with the same
+ *  sequence.
+ *
+ *  Each row that is found is stored once, with the kza, decay
+ *  constant and branching rate of each of its isotopes.  It is then
+ *  entered into the table once for each of its suffixes, at a slot
+ *  found by a hash of the decay time and the kza values of the
+ *  suffix, by open addressing.  A match is always confirmed by
+ *  comparing the suffix itself, including its rates, so that an
+ *  element is only reused when it would be found exactly the same.
+ *
+ *  The table starts with DECAY_CACHE_SIZE slots and doubles whenever
+ *  it becomes half full.  Once the rows hold DECAY_CACHE_LIMIT values,
+ *  the table is emptied to start again.
+ *
+ *  The number of elements that are reused (hits) and that must be
+ *  found (misses) are counted, and reported by report().
+ */
+
+class DecayCache
+{
+ protected:
+
+  /** \brief These objects are the slots of the table.
+   */
+  class CacheData
+    {
+    public:
+      /// The hash of the suffix of this slot.
+      unsigned long hash;
+
+      /// The row of this slot, or NULL in an empty slot.
+      /** For a row of 'size' isotopes, this holds the row size, the
+          decay time, and then the kza values, the decay constants,
+          the branching rates and the off-diagonal elements of the
+          row, 'size' of each.  It is owned by the slot of its
+          longest suffix, the row itself. */
+      double *row;
+
+      /// The rank within the row at which the suffix of this slot
+      /// starts.
+      int first;
+
+      /// Default constructor
+      /** This constructor sets row to NULL. */
+      CacheData() : hash(0), row(NULL), first(0) {};
+    }
+  /// The table of slots, with 'capacity' slots.
+  *table;
+
+  /// The number of slots of 'table', which is always a power of 2.
+  int capacity;
+
+  /// The number of slots of 'table' in use.
+  int nSlots;
+
+  /// The number of values held in the rows of 'table'.
+  long nValues;
+
+  /// The number of hits and misses.
+  static long hits, misses;
+
+  /// This function returns the hash of a suffix from the hash of the
+  /// suffix that starts at the next rank, given in the first argument,
+  /// and the kza value of its first isotope, given in the second.
+  static unsigned long hashNext(unsigned long, double);
+
+  /// This function returns the hash that starts every suffix, from
+  /// the decay time given in the argument.
+  static unsigned long hashTime(double);
+
+  /// This function returns the first slot to probe for the hash
+  /// given in the argument.
+  int slotOf(unsigned long hash)
+    { return (hash ^ (hash >> 29)) & (capacity-1); };
+
+  /// This function returns the first empty slot at or after the slot
+  /// of the hash given in the argument.
+  CacheData* search(unsigned long);
+
+  /// This function checks whether the suffix of the slot given in the
+  /// first argument is the suffix of row 'row' that starts at column
+  /// 'col', with the rest of the arguments as for find(...).
+  static int match(CacheData*, int, int, double*, double*, double*, double);
+
+  /// This function doubles the size of the table.
+  void grow();
+
+  /// This function deletes all the rows of the table.
+  void clear();
+
+ public:
+  /// Default constructor
+  /** This constructor creates an empty table of DECAY_CACHE_SIZE
+      slots. */
+  DecayCache();
+
+  /// This destructor deletes the rows of the table.
+  ~DecayCache();
+
+  /// This function finds the longest suffix of row 'row' of a decay
+  /// matrix that is in the table.
+  /** The kza values, decay constants and branching rates of the
+      isotopes of the chain, by rank in the matrix, are given in the
+      second to fourth arguments and the decay time in the fifth.  It
+      returns the first column of the longest suffix found, or 'row'
+      if none is, and points the last argument at its elements, in
+      order from this column. */
+  int find(int, double*, double*, double*, double, double*&);
+
+  /// This function adds row 'row' of a decay matrix, given in the
+  /// sixth argument, with the arguments of find(...), entering it for
+  /// each of its suffixes that starts before the column given in the
+  /// last argument, as returned by find(...).
+  void add(int, double*, double*, double*, double, double*, int);
+
+  /// This inline function copies the numbers of hits and misses into
+  /// the argument.
+  static void getCounts(long *counts)
+    { counts[0] = hits; counts[1] = misses; };
+
+  /// This inline function adds the numbers of hits and misses given in
+  /// the argument, as from getCounts(...), to those of the table.
+  static void accountCounts(long *counts)
+    { hits += counts[0]; misses += counts[1]; };
+
+  /// This function reports the total numbers of hits and misses.
+  static void report();
+};
+#endif
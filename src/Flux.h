@@ -8,11 +8,28 @@
 #define FLUX_HEAD 0
 #define FLUX_D 1
 #define FLUX_R 2
+#define FLUX_B 3
+
+/* the most characters in a value of a text flux file */
+#define FLUX_TOKEN_LEN 64
+
+/* the numbers of groups and intervals of RTFLUX fluxes transposed
+ * at once */
+#define RTFLUX_TILE 8
+#define RTFLUX_CHUNK 4096
 
 /* results of searching for flux */
 #define FLUX_NOT_FOUND -1
 #define FLUX_BAD_FNAME -2
 
+/* the values of one group for a run of consecutive intervals, stored
+ * in one record of an RTFLUX file */
+struct RTFLUXSegment
+{
+  long firstInt, nInts;
+  long offset;
+};
+
 /** \brief This class is invoked as a linked list and describes the 
  *         flux information of the problem.
  *   
@@ -53,6 +70,111 @@ protected:
   /// The pointer to the next flux description in the list.
   Flux* next;
 
+  /** \brief A flux file opened once for all the flux definitions
+   *         that read it in the same format, and the range of its
+   *         entries read for some of them.
+   */
+  class FileData
+    {
+    public:
+      /// The first interval entry of the range that is read.
+      int firstVol;
+
+      /// The number of interval entries of the range, covering the
+      /// entries of every definition read from it.
+      int numVols;
+
+      /// The fluxes of each interval entry of the range, either in
+      /// 'storage' or in the file mapped into memory, or NULL until
+      /// the range is read.
+      double **rows;
+
+      /// The storage for the fluxes of the range read from the file.
+      double *storage;
+
+      /// The file mapped into memory, if any, with its length.
+      void *mapped;
+      size_t mapLen;
+
+      /// For a text file, the number of chunks that it is cut into,
+      /// the offset at which each starts and the number of values
+      /// before each.
+      int nChunks;
+      size_t *bound;
+      long *first;
+
+      /// For an RTFLUX file, the open file and the segment of each
+      /// group for each run of intervals, 'segsPerGroup' of them.
+      FILE *stream;
+      RTFLUXSegment *segment;
+      int segsPerGroup;
+
+      /// For a binary file, the first value of the first interval, the
+      /// number of bytes from one interval to the next, the size of
+      /// each value and the number of groups of each interval.
+      char *data;
+      long volStride;
+      int dtype, fileGrps;
+
+      /// The number of interval entries held by an RTFLUX or binary
+      /// file.
+      long nInts;
+
+      /// Default constructor
+      FileData() : firstVol(0), numVols(0), rows(NULL), storage(NULL),
+	mapped(NULL), mapLen(0), nChunks(0), bound(NULL), first(NULL),
+	stream(NULL), segment(NULL), segsPerGroup(0), data(NULL),
+	volStride(0), dtype(0), fileGrps(0), nInts(0) {};
+
+      /// This destructor closes the file.
+      ~FileData() { close(); };
+
+      /// This function releases the range read, once every definition
+      /// that it covers has been filled.
+      void releaseRange();
+
+      /// This function releases the range read and closes the file,
+      /// once every definition that reads it has been filled.
+      void close();
+    };
+
+  /// Function to open the file of this definition for the object
+  /// given in the first argument, for the number of groups given in
+  /// the second.
+  void openFile(FileData&, int);
+
+  /// Function to read the range of entries given by the object in the
+  /// first argument from the file opened by openFile(...), for the
+  /// number of groups given in the second.
+  void readRange(FileData&, int);
+
+  /// Function to map a text flux file in the default format into
+  /// memory and count the values that start in each of its chunks,
+  /// with the arguments of openFile(...).
+  void openText(FileData&, int);
+
+  /// Function to convert the range of a text flux file, with the
+  /// arguments of readRange(...).
+  void readText(FileData&, int);
+
+  /// Function to read the header of an RTFLUX binary FORTRAN file
+  /// from DANTSYS, etc., and find the segments of its records, with
+  /// the arguments of openFile(...).
+  void openRTFLUX(FileData&, int);
+
+  /// Function to read the range of an RTFLUX file, with the arguments
+  /// of readRange(...).
+  void readRTFLUX(FileData&, int);
+
+  /// Function to check the header of a flux file in the binary format
+  /// of fluxBinary.h and map it into memory, with the arguments of
+  /// openFile(...).
+  void openBinary(FileData&, int);
+
+  /// Function to read the range of a binary flux file, with the
+  /// arguments of readRange(...).
+  void readBinary(FileData&, int);
+
 public:
   /// Default constructor
   Flux(int inFormat=FLUX_HEAD, const char* flxName=NULL, 
@@ -75,9 +197,6 @@ public:
   /// connected to the stream given in the first argument.
   Flux* getFlux(istream&);
 
-  /// Function to read RTFLUX binary FORTRAN output from DANTSYS, etc.
-  void readRTFLUX(double*, int, int);
-
   /// Setup the problem to read the actual flux data into containers in each
   /// interval.
   void xRef(Volume*);
@@ -13,17 +13,32 @@ class Matrix
   friend void Chain::fillTMat(Matrix&, double, int);
   friend void Chain::setDecay(Matrix&, double);
   friend void Chain::mult(Matrix&, Matrix&, Matrix&);
+  friend void Chain::mult(Matrix**, Matrix&, Matrix**);
+  friend void Chain::multResults(double*, Matrix&, Matrix&);
+  friend class MatrixBatch;
 
 protected:
   int size;
+
+  /// The number of rows for which 'data' has room, which is never
+  /// less than 'size'.
+  int capacity;
+
+  /// The packed rows of the matrix, followed by room for one more row
+  /// of 'capacity' values used as work space by the products (see
+  /// triMult(...)).
   double *data;
 
+  /// This function returns the work space at the end of 'data'.
+  double* workRow() { return data+capacity*(capacity+1)/2; };
+
   void square();
 
 public:
-  Matrix() { size = 0; data = NULL; };
+  Matrix() { size = 0; capacity = 0; data = NULL; };
   Matrix(int);
   Matrix(const Matrix&);
+  Matrix(Matrix&&);
   Matrix(double*,int,int);
   ~Matrix();
 
@@ -31,12 +46,48 @@ public:
   Matrix& operator*=(const Matrix&);
   Matrix operator^(int);
   Matrix& operator=(const Matrix&);
+  Matrix& operator=(Matrix&&);
   double& operator[](int idx) { return data[idx]; };
 
   int getSize() { return size; };
 
   double rowSum(int);
 
+  /// This function makes room for the number of rows given in the
+  /// argument, keeping the current rows.
+  void reserve(int);
+
+  /// This function sets the size to the first argument, keeping the
+  /// rows that fit, and makes room for at least the number of rows
+  /// given in the second argument.
+  /** The storage is only reallocated when it is too small, and then
+      at least doubled, so that a matrix which is resized with each
+      chain is soon resized in place. */
+  void resize(int, int cap=0);
+
+  /// This function deletes the storage of the matrix, leaving it
+  /// empty.
+  void clear();
+
+  /// This function returns the number of bytes of storage held by the
+  /// matrix.
+  long storage()
+    { return (data != NULL ? (long)capacity*(capacity+3)/2*sizeof(double) : 0); };
+
+  /// This function sets this matrix to the product of the two
+  /// arguments, neither of which may be this matrix.
+  void product(const Matrix&, const Matrix&);
+
+  /// This function multiplies this matrix, in place, on the left by
+  /// the argument.
+  void premult(const Matrix&);
+
+  /// This function raises this matrix, in place, to the power given
+  /// in the first argument, using the last two arguments as scratch.
+  /** Large powers are found in closed form from the diagonal elements
+      when this can be done accurately (see triPower(...)). */
+  void power(int, Matrix&, Matrix&);
+
 };
 
 #endif
@@ -0,0 +1,95 @@
+/* $Id$ */
+#include "alara.h"
+
+#ifndef MATRIXBATCH_H
+#define MATRIXBATCH_H
+
+#include "Matrix.h"
+
+/** \brief This class stores a batch of lower triangular matrices of
+ *         the same size, one for each interval of a block of intervals.
+ *
+ *  The matrices are stored element by element: all the values of the
+ *  first element, one per matrix in the batch, then all the values of
+ *  the second element, and so on.  The inner loops of the products
+ *  then run over the matrices of the batch, with unit stride, for each
+ *  element.  Each matrix of the batch goes through exactly the same
+ *  arithmetic as it would in a Matrix, so the results are identical.
+ */
+
+class MatrixBatch
+{
+protected:
+  /// The size of each lower triangular matrix.
+  int size;
+
+  /// The number of matrices in the batch.
+  int nBatch;
+
+  /// The number of values for which 'data' has room.
+  int capacity;
+
+  /// The storage for the matrices, with element 'idx' of matrix 'b'
+  /// at data[idx*nBatch+b], followed by room for one more row of each
+  /// matrix, used as work space by the products.
+  double *data;
+
+  void square();
+
+public:
+  MatrixBatch() { size = 0; nBatch = 0; capacity = 0; data = NULL; };
+  MatrixBatch(int,int);
+  MatrixBatch(const MatrixBatch&);
+  MatrixBatch(MatrixBatch&&);
+  MatrixBatch(Matrix**,int);
+  ~MatrixBatch();
+
+  MatrixBatch operator*(const MatrixBatch&);
+  MatrixBatch operator*(const Matrix&);
+  MatrixBatch& operator*=(const MatrixBatch&);
+  MatrixBatch operator^(int);
+  MatrixBatch& operator=(const MatrixBatch&);
+  MatrixBatch& operator=(MatrixBatch&&);
+
+  /// Returns the vector of values of element 'idx' across the batch.
+  double* operator[](int idx) { return data+idx*nBatch; };
+
+  int getSize() { return size; };
+
+  /// This function returns the work space following the matrices.
+  double* workRow() { return data+size*(size+1)/2*nBatch; };
+
+  /// This function sets the number of matrices and their size to the
+  /// two arguments, leaving their values undefined.
+  /** The storage is only reallocated when it is too small, and then
+      at least doubled. */
+  void resize(int,int);
+
+  /// This function copies the matrices pointed to by the first
+  /// argument, which must all have the same size, into the batch.
+  void gather(Matrix**,int);
+
+  /// This function sets this batch to the products of the matrices of
+  /// the batch in the first argument with the single matrix in the
+  /// second argument.  The first argument may not be this batch.
+  void product(const MatrixBatch&, const Matrix&);
+
+  /// This function multiplies each matrix of this batch, in place, on
+  /// the left by the matching matrix of the argument.
+  void premult(const MatrixBatch&);
+
+  /// This function raises each matrix of this batch, in place, to the
+  /// power given in the first argument, using the last three arguments
+  /// as scratch.
+  /** Large powers are found in closed form, matrix by matrix, as in
+      Matrix::power(...). */
+  void power(int, MatrixBatch&, MatrixBatch&, MatrixBatch&);
+
+  /// This function copies the batch back into the matrices pointed
+  /// to by the first argument, keeping the rows of those matrices
+  /// above the row given in the second argument.
+  void scatter(Matrix**, int firstRow=0);
+
+};
+
+#endif
@@ -138,6 +138,10 @@ public:
   /// contain this mixture.
   void refFlux(Volume*);
 
+  /// This function loops through each of the Mixture objects, creating
+  /// the table of reaction rates for the list of intervals of each.
+  void makeRateTables();
+
   /// Function simply passes the two arguments, the chain information
   /// and the schedule information, to the list of intervals which
   /// contain this mixture.  
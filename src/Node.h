@@ -109,18 +109,21 @@ public:
 
   /// Inline function that sends information about the current node to the
   /// statistics routines for diagnostic and tree output.
-  int count(double* relProd)
+  /** Without a relative production, 'relBound' may give a bound on it
+      (see Statistics::accountNode(...)). */
+  int count(double* relProd, double relBound=-1)
    {  
      if (prev)
        {
 	 nodenum= Statistics::accountNode(kza,prev->emitted[prev->pathNum-1],
-				       rank,state,relProd, prev->nodenum);
+				       rank,state,relProd, prev->nodenum,
+				       relBound);
 	 return nodenum;
        }   
       else
 	{
 	  nodenum=Statistics::accountNode(kza,NULL,
-				       rank,state,relProd,0);
+				       rank,state,relProd,0,relBound);
 	  return nodenum;
 	}
     };
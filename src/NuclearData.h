@@ -4,6 +4,8 @@
 #ifndef NUCLEARDATA_H
 #define NUCLEARDATA_H
 
+typedef std::map<int,NuclearData*,std::less<int> > NuclearDataStore;
+
 /** \brief Stores the nuclear data information for a particular isotope 
            in the chain.
  *
@@ -27,6 +29,33 @@ protected:
   /// The number of groups in the data library.
   static int nGroups;
 
+  /// This is the shared store of isotope data, keyed by KZA.
+  /** Each isotope is read from the library, converted and sorted only
+      once per run, into an entry of this store.  The entries are
+      never changed after that: the nodes of the chains view the data
+      of an entry rather than owning a copy of it. */
+  static NuclearDataStore dataStore;
+
+  /// For an entry of 'dataStore', this is the number of objects
+  /// viewing its data, and it is -1 for all other objects.
+  int refCount;
+
+  /// This points to the entry of 'dataStore' whose data this object
+  /// views, and is NULL otherwise.
+  NuclearData *shared;
+
+  /// This flag indicates whether the arrays 'relations', 'emitted'
+  /// and 'paths' of a viewing object belong to it.
+  /** This is only the case once stripNonDecay() has shortened them.
+      The strings and rate vectors they point to always belong to the
+      entry being viewed. */
+  int ownIndex;
+
+  /// This flag indicates whether the rate vectors and the emitted
+  /// strings of this object belong to the data library, which keeps
+  /// them ready for use in its image, rather than to this object.
+  int inLib;
+
   /// The number of reactions to be processed for this isotope.
   /** This can be interpreted physically in a number of ways depending
       on the library structure, but computationally it represents the
@@ -51,7 +80,9 @@ protected:
   /// related to the "previous" isotope by both transmutation (groups
   /// 1..N) and decay (group N+1).
   /** For forward calculations, this is the production rate, and for
-      backward, it is the total destruction rate. */
+      backward, it is the total destruction rate.  It points into the
+      data of an entry of 'dataStore', and only belongs to the entry
+      itself. */
   double *single;
   
   /** This is an array of rate vectors describing the rates related to
@@ -80,16 +111,33 @@ protected:
   /// moving the decay reaction paths to the beginning of the list.
   void sortData();
 
+  /// {Chain Building} This function points this object at the data of
+  /// the isotope with the KZA of the argument in 'dataStore', first
+  /// reading it from the library if it is not there yet.
+  void getData(int);
+
+  /// {Service} This function points this object at the data of the
+  /// entry of 'dataStore' pointed to by the argument.
+  void view(NuclearData*);
+
+  /// {Service} This function makes this object view the same data as
+  /// the object of the argument, for copying.
+  void copyView(const NuclearData&);
+
  public:
 
   /// {Input Handling} This function reads the library type and calls for the
   /// creation of a new DataLib object.
   static void getDataLib(istream&);
 
-  /// {Service/Cleanup} This function simply deletes the static member 
-  /// 'dataLib'.
+  /// {Service/Cleanup} This function deletes the static member 
+  /// 'dataLib' and releases the entries of 'dataStore'.
   static void closeDataLib();
 
+  /// {Service} This function asks 'dataLib' to reopen its files for
+  /// use by a worker process.
+  static void reopenDataLib();
+
   /// {Input Handling} This inline function just sets NuclearData::mode
   /// variable into the reverse mode.
   static void modeReverse() { mode = MODE_REVERSE;};
@@ -98,14 +146,6 @@ protected:
   /// NuclearData::mode
   static int getMode() { return mode; };
 
-  /*
-    NuclearData(double*)
-    The basic constructor is used when adding new Node's to the chain.
-    After initializations identical to the default constructor, it
-    creates and fills the storage for 'P' by copying the passed array
-    on an element-by-element basis.
-  */
-
   /// The default constructor.
   NuclearData();
 
@@ -122,12 +162,23 @@ protected:
   
   /// This function performs all the memory allocation required when
   /// deleting or resetting the values of a NuclearData object.
+  /** For an object viewing an entry of 'dataStore', this releases the
+      entry instead. */
   void cleanUp();
   
   /// {%Chain Building} Callback function to pass data back from library 
   /// routines.
   void setData(int, float *, int *, char **, float **, float, float*);
 
+  /// {%Chain Building} Callback function to pass data back from library
+  /// routines whose rate vectors and emitted strings are stored ready
+  /// for use, and are used in place.
+  void setData(int, double *, int *, char **, double **);
+
+  /// The ALARA v2 library converter stores the rate vectors as they
+  /// are built by setData(...).
+  friend class ALARA2Lib;
+
 };
 
 
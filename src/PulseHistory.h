@@ -70,8 +70,20 @@ public:
   void setDecay(Chain*);
 
   /// This function performs the mathematics required to represent the
-  /// pulsing history.
-  Matrix doHistory(Matrix);
+  /// pulsing history, applying it to the transfer matrix of the
+  /// second argument and placing the result in the third argument.
+  /** The temporaries are taken from the arena of the chain pointed to
+      by the first argument. */
+  void doHistory(Chain*, Matrix&, Matrix&);
+
+  /// This function performs the same mathematics for the transfer
+  /// matrices of a block of intervals, given in the second argument,
+  /// and places the results in the matrices of the third argument.
+  void doHistory(Chain*, Matrix**, Matrix**, int);
+
+  /// This function returns the duration of this pulsing history when
+  /// applied to an operation of the duration given in the argument.
+  double duration(double);
 
   /// This function writes the details of each pulse history to the
   /// output file.
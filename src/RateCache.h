@@ -7,130 +7,221 @@
 #define CACHE_SIZE 64
 #define BLANK_KZA 9999999
 
-/** \brief This class stores implements a fixed size cache for scalar
- *         reaction rates.  (One of these objects is associated with 
- *         each flux in the problem.)
- *  
- *  The fixed size cache (see CACHE_SIZE below) keeps track of all the
- *  reactions for CACHE_SIZE isotopes.  An array of CacheListPtrs is
- *  sorted by the kza number of the base isotope.  Each CacheListPtr 
- *  has a pointer to a CacheData object which contains an array of 
- *  rates, one for each reaction that this base isotope sees.
+/* the number of rate vectors folded together */
+#define FOLD_VEC_BLOCK 4
+
+/* the bound on the storage of all the tables, in megabytes, when no
+ * memory budget is given */
+#define RATE_TABLE_MB 256
+
+/* the number of counters given by getCounts(...): hits, misses, the
+ * peak storage and the number of times a table was emptied */
+#define NUMRATECOUNTS 4
+
+/** \brief This class implements a dense table of scalar reaction
+ *         rates for all the fluxes of a list of intervals.  (One of
+ *         these objects is associated with each mixture in the
+ *         problem, and with each reference volume.)
+ *
+ *  The isotopes are held in a hashed table of slots, one for each
+ *  base isotope, found by open addressing: starting at a slot given
+ *  by a hash of its kza, the slots are probed in turn until either
+ *  the isotope or an empty slot is found, and no entries are moved
+ *  when it is found.  The table starts with CACHE_SIZE slots and
+ *  doubles whenever it becomes half full, so its size follows the
+ *  number of isotopes in the problem.  It is emptied to start again
+ *  when the number of isotopes reaches 'maxIsotopes', which is set
+ *  from the size of the data library, or when the rows of a chain
+ *  would take the storage over its bound.  When a memory budget is
+ *  set, the rows are counted against it together with the transfer
+ *  matrices (see topScheduleT), and otherwise the rows of all the
+ *  tables are bounded by RATE_TABLE_MB.
  *
- *  The CacheData objects are also stored as a doubly-linked list, 
- *  sorted by which object was used most recently.  When the cache is 
- *  full, the least recently used isotope is deleted from the cache in 
- *  order to add the new object.  The CacheData objects store the 
- *  index of the CacheListPtr which points to it, in order to replace 
- *  the value of the CacheListPtr with those the new isotope.  At each 
- *  addition, the array of CacheListPtrs is sorted using a simple bubble 
- *  sort [O(N)].
+ *  Each slot holds a row for each reaction of its isotope that has
+ *  been folded.  Each row holds the rate vector of that reaction
+ *  folded with every column, and each column is one flux of one
+ *  interval.  The rows of a chain are found once by
+ *  Chain::foldRates(...) before its intervals are solved, so that
+ *  collapsing the rates of an interval is only a matter of looking up
+ *  its column in each row.
  *
- *  Some simple analysis has shown that CACHE_SIZE=64 will only have a
- *  cache miss about 1% of the time for a typical problem.  Cache misses
- *  are most likely when changing root isotope, and especially when the
- *  new root isotope has a Z very different from that of the old root
- *  isotope.
+ *  The fluxes of the columns are not copied: each column points at
+ *  the flux of its VolFlux, which for the intervals is in the slab of
+ *  VolFlux.  The rows that are not yet in the table are folded
+ *  together as a blocked product of their rate vectors with the flux
+ *  of each column in turn.  The rates of a column are summed over the
+ *  groups in the same order as a single scalar product would be.
+ *
+ *  The number of rows that are found (hits) and that must be folded
+ *  (misses) are counted, and reported by report().
  */
 
 class RateCache
 {
  protected:
 
-  /** \brief These objects contain the actual data for the cache.
+  /** \brief These objects are the slots of the table.
    */
-  class CacheData 
+  class CacheData
     {
     public:
-      /// This is an index into the array RateCache::kzaList,
-      /// indicating which CacheListPtr object points to this 
-      /// CacheData object.
-      int kzaIdx;
+      /// Hash integer defining the isotope, BLANK_KZA in an empty slot.
+      int kza;
 
-      /// This dynamically allocated array of doubles has scalar nuclear
+      /// The number of reactions of this base isotope, including the
+      /// total destruction rate.
+      int nRates;
+
+      /// This dynamically allocated array has a row of scalar nuclear
       /// reaction rates for each reaction for this base isotope
-      /// (including the total destruction rate).
-      double *cache;
-
-      /// Pointer to implement the doubly linked list
-      CacheData *next;
-        
-      /// Pointer to implement the doubly linked list
-      CacheData *prev;
-      
+      /// (including the total destruction rate), or NULL for a
+      /// reaction that has not been folded.
+      double **rows;
+
       /// Default constructor
-      /** This constructor sets kzaIdx to -1, and all the pointers to 
-          NULL. */
-      CacheData() : kzaIdx(-1), cache(NULL), next(NULL), prev(NULL) {};
+      /** This constructor sets kza to BLANK_KZA and rows to NULL. */
+      CacheData() : kza(BLANK_KZA), nRates(0), rows(NULL) {};
+    }
+  /// The table of slots, with 'capacity' slots.
+  *table;
 
-      /// This, if the single argument is greater than 0, allocates
-      /// that many doubles and points 'cache' at this new array.
-      CacheData(int);
+  /// The number of slots of 'table', which is always a power of 2.
+  int capacity;
 
-      /// Default destructor deletes the whole linked list by deleting
-      /// 'next'.
-      ~CacheData() { delete[] cache; delete next; next=NULL; };
+  /// The number of bits of the hash used to index 'table'.
+  int hashBits;
 
-    }
-  /// This points to the least recently used data.  
-  /** It therefore serves as a pointer to the whole list from one 
-      side. */
-  *oldestData, 
-    
-  /// This points to the most recently used data.
-  /** It also serves as a pointer to the whole list form the other 
-      side. */
-  *lastUsedData;
-  
-  class CacheListPtr 
-    {
-    public:
-      /// Hash integer defining the isotope.  This is the search/sort 
-      /// key for the array of these objects.
-      int kza;
+  /// The number of isotopes in 'table'.
+  int nIsotopes;
+
+  /// The number of columns, i.e. the length of each row.
+  int nColumns;
+
+  /// The flux of each column, which belongs to its VolFlux, or NULL
+  /// for a flux that is all zero.
+  const double **colFlux;
+
+  /// The number of bytes of the rows of this table.
+  long bytes;
 
-      /// This is a pointer to the CacheData object which corresponds to
-      /// this isotope.
-      CacheData *dataPtr;
-      
-      /// Default Constructor
-      /** This constructor uses an initialization list sets kza
-          to the value of the single argument (with BASE_KZA being the
-          default) and sets dataPtr to NULL. */
-      CacheListPtr(int baseKza=BLANK_KZA) : kza(baseKza), dataPtr(NULL) {};   
-    } 
-  /// This static array is a sorted list of CacheListPtrs, initially
-  /// filled with kza=BLANK_KZA in all locations.
-  kzaList[CACHE_SIZE];
-  
-  /// This function performs a simple binary search for the single
-  /// argument on the kzaList array.
+  /// The number of rows waiting to be folded by foldPending().
+  int nPending;
+
+  /// The length of the storage allocated for 'pendingVecs' and
+  /// 'pendingRows'.
+  int pendingLen;
+
+  /// The rate vectors of the rows waiting to be folded.
+  double **pendingVecs;
+
+  /// The rows waiting to be folded.
+  double **pendingRows;
+
+  /// The largest number of isotopes held before 'table' is emptied.
+  static int maxIsotopes;
+
+  /// The number of hits and misses.
+  static long hits, misses;
+
+  /// The number of bytes of the rows of all the tables, and the
+  /// largest value it has had.
+  static long heldBytes, peakBytes;
+
+  /// The number of times that a table has been emptied.
+  static long nEmptied;
+
+  /// This function returns the slot of the isotope given in the
+  /// argument, or the empty slot where it would be added.
   RateCache::CacheData* search(int);
 
-  /// This function adds a new CacheData object, preforms all the
-  /// management of the linked list related to this, inserts the kza
-  /// reference into kzaList, and performs a bubble sort on kzaList.
-  RateCache::CacheData* add(int,int);
+  /// This function adds the isotope given in the first argument, with
+  /// storage for the number of rows given in the second argument, at
+  /// the empty slot given in the last argument.
+  RateCache::CacheData* add(int,int,CacheData*);
+
+  /// This function doubles the size of the table.
+  void grow();
+
+  /// This function counts the number of bytes given in the argument,
+  /// which may be negative, as held by the rows of this table.
+  void hold(long);
+
+  /// This function deletes all the data of the table.
+  void clear();
 
  public:
-  /// Default constructor 
-  /** This constructor relies on default constructors for all of
-      its members execpt oldestData and lastUsedData, which are set
-      to NULL. */
-  RateCache() : oldestData(NULL), lastUsedData(NULL) {};
-
-  /// This default destructor relies on default destructors for all
-  /// members, but deletes the linked list by deleting oldestData.
-  ~RateCache();
+  /// Default constructor
+  /** This constructor creates an empty table of CACHE_SIZE slots
+      with the number of columns given in the argument, none of which
+      has a flux yet. */
+  RateCache(int numColumns=0);
 
-  /// This function searches for the isotope indicated by the first
-  /// argument and the reaction indexed by the second argument.
-  double read(int,int);
+  /// The copy constructor starts with an empty table of the same
+  /// columns.
+  RateCache(const RateCache&);
 
-  /// This function sets the entry in the cache for the isotope indcated
-  /// by the first argument and the reaction indexed by the second
-  /// argument.
-  void set(int,int,int,double);
+  /// This destructor deletes the data of the table.
+  ~RateCache();
+
+  /// The assignment operator copies the columns and empties the
+  /// table.
+  RateCache& operator=(const RateCache&);
+
+  /// This function points the column given in the first argument at
+  /// the flux pointed to by the second argument, which must stay in
+  /// place as long as the table.
+  void setFlux(int, double*);
+
+  /// This function empties the table if it holds 'maxIsotopes'
+  /// isotopes, or if the number of rows given in the argument would
+  /// take the storage over its bound.
+  /** It must be called before the rows of a chain are found, since
+      rows found earlier are no longer valid once it has emptied the
+      table. */
+  void checkLimit(int);
+
+  /// This function returns the row for the isotope indicated by the
+  /// first argument and the reaction indexed by the third argument,
+  /// with the second argument giving the number of reactions of this
+  /// isotope.
+  /** A row that is not yet in the table is created and will be
+      filled by folding the rate vector pointed to by the last
+      argument at the next call to foldPending(). */
+  double* getRow(int,int,int,double*);
+
+  /// This function folds all the rows created by getRow(...) since
+  /// the last call.
+  void foldPending();
+
+  /// This inline function sets the largest number of isotopes held
+  /// in each table, with 0 for no limit.
+  static void setMaxIsotopes(int numIsotopes)
+    { maxIsotopes = numIsotopes; };
+
+  /// This inline function copies the numbers of hits and misses, the
+  /// peak storage of the tables and the number of times that a table
+  /// was emptied into the argument.
+  static void getCounts(long *counts)
+    {
+      counts[0] = hits;
+      counts[1] = misses;
+      counts[2] = peakBytes;
+      counts[3] = nEmptied;
+    };
+
+  /// This inline function adds the counters given in the argument, as
+  /// from getCounts(...), to those of the tables.
+  static void accountCounts(long *counts)
+    {
+      hits += counts[0];
+      misses += counts[1];
+      peakBytes += counts[2];
+      nEmptied += counts[3];
+    };
+
+  /// This function reports the total numbers of hits and misses, and
+  /// the peak storage of the tables.
+  static void report();
 };
 #endif
 
@@ -153,6 +153,17 @@ public:
   
   // NEED COMMENT
   static void closeBinDump() { fclose(binDump); };
+
+  /// This inline function replaces the binary dump file with the one
+  /// given in the argument and returns the one it replaced.
+  /** It is used by worker processes in a parallel solution to write
+      their results to a private file. */
+  static FILE* swapBinDump(FILE* newDump)
+    { FILE* oldDump = binDump; binDump = newDump; return oldDump; };
+
+  /// This function copies a block of a worker's dump file, given by
+  /// an offset and length, to the end of the binary dump file.
+  static void appendDump(FILE*, long, long);
   
   /// This function writes the results stored in 'this' entire list to the
   /// binary dump file.
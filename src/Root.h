@@ -119,6 +119,15 @@ protected:
    
   /// This function adds a root isotope to the list of root isotopes.
   void add(Root*);
+
+  /// This function builds and solves all the chains of this root
+  /// isotope, returning the number of chains.
+  int solveChains(topSchedule*);
+
+  /// This function solves the list of roots beginning with the first
+  /// argument using the number of worker processes given in the last
+  /// argument.
+  static void solveParallel(Root*, topSchedule*, int);
   
 public:
   /// Default constructor 
@@ -147,7 +156,8 @@ public:
     { mixList->refFlux(refVolume); };
 
   /// This function is the top level of the solution phase.
-  void solve(topSchedule*);
+  /** The optional second argument gives the number of parallel jobs. */
+  void solve(topSchedule*, int nJobs=1);
   
   /// This function calls MixCompRef::readDump() for each root isotope
   /// in the problem.
@@ -39,6 +39,10 @@
     This is a machine-dependent normalization used to convert the
     cputime measures to seconds.
 
+ methodCtr : long[NUMMETHODS]
+    This counts the elements of the transfer matrices filled by each
+    method, indexed by the METHOD_* constants.
+
  runtime : float[2]
     This variable stores a pair or times, used to find delta times for
     different parts of the solution.
@@ -46,10 +50,11 @@
  *** Static Member Functions ***
 
 
- int accountNode(int,char*,int,int,double*, int)
+ int accountNode(int,char*,int,int,double*, int, double)
     This function increments nodeCtr, and then writes the information
     about this node to the tree file(s), if requested. The current value
-    of nodeCtr (after the incrementing) is returned.
+    of nodeCtr (after the incrementing) is returned.  If no relative
+    production is given, the last argument may give a bound on it.
 
  int accountChain(int)
     This inline function increments chainCtr and, if the rank given in
@@ -92,6 +97,39 @@
  int getNodeCtr()
     This function simply returns the value of NodeCtr
 
+ void redirectTree(const char*, const char*)
+    This function is called by a worker process in a parallel
+    solution.  If tree files were requested, it closes them and opens
+    the text and binary files named in the two arguments in their
+    place.
+
+ void treePosition(long&, long&)
+    This function returns the current positions in the text and
+    binary tree files, or 0 for a file that was not requested.
+
+ void appendTree(const char*, long, long, const char*, long, long, int)
+    This function copies the block of a worker's text tree file (name,
+    offset, length) and binary tree file (name, offset, length) for a
+    single root to the problem's tree files.  The node numbers in the
+    binary records are shifted by the final argument so that they
+    match those of a serial solution.
+
+ void tallyRoot(int, int, int)
+    This inline function adds the number of nodes and chains, and
+    the maximum rank, of one root solved by a worker process to the
+    problem counters.
+
+ void accountMethods(long*)
+    This inline function adds the counts of the elements filled by
+    each method, given in the argument, to 'methodCtr'.
+
+ void getMethods(long*)
+    This inline function copies 'methodCtr' into the argument.
+
+ void reportMethods()
+    This function reports the number of elements of the transfer
+    matrices filled by each method.
+
 */
 
 #ifndef STATISTICS_H
@@ -144,10 +182,14 @@ protected:
   /// different parts of the solution.
   static float runtime[2];
 
+  /// This counts the elements of the transfer matrices filled by each
+  /// method, indexed by the METHOD_* constants.
+  static long methodCtr[NUMMETHODS];
+
 public:
   /// This function increments nodeCtr, and then writes the information
   /// about this node to the tree file(s), if requested. 
-  static int accountNode(int,char*,int,int,double*, int);
+  static int accountNode(int,char*,int,int,double*, int, double);
 
   /// This inline function increments chainCtr 
   /** If the rank given in the argument is greater than 'maxRootRank', it 
@@ -186,6 +228,28 @@ public:
   /// This function finds the current runtime from a system call
   static void cputime(float&,float&);
 
+  /// This function sends the tree output of a worker process to the
+  /// pair of private files named in the arguments.
+  static void redirectTree(const char*, const char*);
+
+  /// This function returns the current positions in the text and
+  /// binary tree files through its two reference arguments.
+  static void treePosition(long&,long&);
+
+  /// This function appends one root's tree output from a worker's
+  /// private files to the tree files of the problem.
+  static void appendTree(const char*, long, long, const char*, long, long, 
+			 int);
+
+  /// This inline function adds the counts from one root solved by a
+  /// worker process to the counters for the whole problem.
+  static void tallyRoot(int nodes, int chains, int rank)
+  {
+    nodeCtr += nodes;
+    chainCtr += chains;
+    maxProblemRank = std::max(maxProblemRank,rank);
+  };
+
   /// This inline function provides access to the current value of
   /// nodeCtr.
   static int numNodes()
@@ -196,6 +260,25 @@ public:
   static int maxRank()
     { return maxProblemRank; };
 
+  /// This inline function adds the counts of the elements filled by
+  /// each method, given in the argument, to 'methodCtr'.
+  static void accountMethods(long *counts)
+    {
+      for (int method=0;method<NUMMETHODS;method++)
+	methodCtr[method] += counts[method];
+    };
+
+  /// This inline function copies 'methodCtr' into the argument.
+  static void getMethods(long *counts)
+    {
+      for (int method=0;method<NUMMETHODS;method++)
+	counts[method] = methodCtr[method];
+    };
+
+  /// This function reports the number of elements of the transfer
+  /// matrices filled by each method.
+  static void reportMethods();
+
 };
 
 #endif
@@ -7,8 +7,6 @@
 #define REFFLUX_MAX     0
 #define REFFLUX_VOL_AVG 1
 
-#include "RateCache.h"
-
 /** \brief This class stores the information about the neutron fluxes in 
  *         each interval.  
  *         
@@ -36,8 +34,19 @@ protected:
   /// Number of charged particle energy groups
   static int nCPEG;
 
+  /// The flux slab: the neutron fluxes of every flux of every
+  /// interval of the problem in a single array.
+  /** The fluxes of each interval are stored together, one flux after
+      another, so that the flux 'fluxNum' of interval 'volNum' starts
+      at (volNum*nFluxes + fluxNum)*nGroups. */
+  static double *slab;
+
   /// Neutron flux storage
   double *nflux;
+
+  /// A flag indicating that 'nflux' is part of the flux slab, and so is
+  /// not deleted with this object.
+  int inSlab;
     
   /// Charged particle flux storage
   double **CPflux;
@@ -45,9 +54,10 @@ protected:
   /// Storage for Charged particle flux
   double *CPfluxStorage;
 
-  /// A data cache to prevent refolding the cross-sections with the
-  /// fluxes too often.  (see RateCache)
-  RateCache cache;
+  /// The column of this flux in the table of reaction rates of its
+  /// mixture or reference volume (see RateCache), or -1 if it has
+  /// none.
+  int column;
 
   /// A pointer to the next VolFlux object in this list.
   VolFlux *next;
@@ -80,6 +90,20 @@ public:
   /// Inline function queries the number of neutron groups.
   static int getNumGroups() 
     { return nGroups; };
+
+  /// This function creates the flux slab for the number of intervals
+  /// given in the argument, with the current numbers of fluxes and
+  /// groups.
+  static void makeSlab(int);
+
+  /// This function deletes the flux slab.
+  static void deleteSlab();
+
+  /// Inline function provides access to the storage of the flux given
+  /// in the second argument of the interval given in the first, in the
+  /// flux slab.
+  static double* getSlab(int volNum, int fluxNum)
+    { return slab + ((long)volNum*nFluxes + fluxNum)*nGroups; };
   
   /// Inline function sets the type of reference flux to use.
   static void setRefFluxType(char refflux_type_code)
@@ -105,8 +129,10 @@ public:
   /// Copy constructor 
   VolFlux(const VolFlux&);
 
-  /// This constructor reads the flux data from an array.
-  VolFlux(double*, double);
+  /// This constructor reads the flux data from an array, scaled by the
+  /// second argument, into the storage given in the last argument, or
+  /// its own storage if that is NULL.
+  VolFlux(double*, double, double* = NULL);
   
   /// This constructor reads the flux values from a file attached to the
   /// first argument stream reference and scales them by the second
@@ -115,11 +141,13 @@ public:
    
 
   /// Inline destructor
-  /** Deletes storage for 'flux' and destroys list of VolFlux objects by
-      deleting 'next'. Also deletes CPflux*/
+  /** Deletes storage for 'flux', unless it is part of the flux slab,
+      and destroys list of VolFlux objects by deleting 'next'. Also
+      deletes CPflux*/
   ~VolFlux()
     { 
-      delete[] nflux; 
+      if (!inSlab)
+	delete[] nflux; 
       delete[] CPfluxStorage;
       delete[] CPflux;
       delete next;
@@ -133,8 +161,9 @@ public:
   /// arguments to the VolFlux(ifstream&,double) constructor.  
   VolFlux* read(ifstream &, double );
 
-  /// NEED COMMENT
-  VolFlux* copyData(double *, double);
+  /// This function extends the list of flux info by passing the
+  /// arguments to the VolFlux(double*,double,double*) constructor.
+  VolFlux* copyData(double *, double, double* = NULL);
 
   /// This function compares the flux of the object through which it is
   /// called with the object pointed to by the argument, and sets the
@@ -145,9 +174,13 @@ public:
   /// argument.
   void scale(double);
   
-  /// This function takes a rate vector pointed to by the first argument
-  /// and folds it with this flux, returning the scalar reaction rate.
-  double fold(double*,Node*);
+  /// Inline function sets the column of this flux in its table of
+  /// reaction rates.
+  void setColumn(int setCol) { column = setCol; };
+
+  /// Inline function provides access to the column of this flux in
+  /// its table of reaction rates.
+  int getColumn() { return column; };
 
   /// Inline function provides access to the 'next' object in the list.
   VolFlux* advance() {return next;};
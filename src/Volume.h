@@ -12,13 +12,19 @@
 /** \brief This class is invoked as a linked list and describes the 
  *         various geometrical intervals of the problem.  
  *
- *  Each Volume object is a member of two lists: the first is 
- *  problem-wide (a member of an object of class Input) and has the 
- *  Volume objects in the order they were input or created 
- *  (see Dimension::convert()), and the second is a list of intervals
- *  for each mixture.  The first element of the main problem-wide list
- *  has type VOL_HEAD (defined through the volume member), and contains
- *  no problem data.
+ *  Each Volume object is a member of the problem-wide list (a member
+ *  of an object of class Input), which has the Volume objects in the
+ *  order they were input or created (see Dimension::convert()).  The
+ *  first element of this list has type VOL_HEAD (defined through the
+ *  volume member), and contains no problem data.
+ *
+ *  Once the intervals are cross-referenced with the mixtures, they
+ *  are also held in the interval table, a set of static arrays
+ *  indexed by the number of the interval in the problem-wide list,
+ *  and each mixture's list head holds the array of the numbers of the
+ *  intervals that contain it.  The problem-wide operations traverse
+ *  the table rather than the list, and the fluxes of all the
+ *  intervals are stored together in a single slab (see VolFlux).
  */
 
 class Volume
@@ -67,6 +73,14 @@ protected:
       the different transfer matrices. */
   topScheduleT* schedT;
 
+  /// A pointer to the table of reaction rates of this mixture or
+  /// reference volume.
+  /** This is only created, by makeRateTable(), for the head of the
+      list of intervals of a mixture and for a reference volume, and is
+      NULL for all other objects.  Each flux of each interval is a
+      column of this table. */
+  RateCache* rateTable;
+
   /// A linked list of results.
   /** Each Result item in the list points to a linked list of results 
       for a particular root isotope.  There is one Result item in the
@@ -96,13 +110,39 @@ protected:
       necessarily adjacent to the current Volume. */
   Volume* next;
  
-  /// A pointer to the next Volume object in the mixture list.
-  /** This pointer represents the next Volume that contains the same
-      mixture as the current Volume, and comes next in the geometric
-      sequence.  This next Volume is not necessarily adjacent to the
-      current Volume. This is used to traverse the set of Volumes
-      that contain the same mixture. */
-  Volume* mixNext;
+  /// The number of this interval in the interval table, or -1 if it
+  /// is not in the table.
+  int intvlNum;
+
+  /// The numbers of the intervals that contain this mixture, in the
+  /// geometric sequence.
+  /** This is only used by the head of the list of intervals of a
+      mixture, and is used to traverse the set of Volumes that contain
+      the same mixture.  It is extended by addMixList(...). */
+  int *mixIntvls;
+
+  /// The number of intervals in 'mixIntvls'.
+  int nMixIntvls;
+
+  /// The length of the storage allocated for 'mixIntvls'.
+  int mixIntvlsLen;
+
+  /// The number of intervals in the interval table.
+  static int nIntvls;
+
+  /// The interval table: a pointer to each interval of the problem,
+  /// in the order of the problem-wide list.
+  static Volume **intvlTable;
+
+  /// The volume of each interval in the interval table.
+  static double *intvlVolume;
+
+  /// The spatial normalization of each interval in the interval table.
+  static double *intvlNorm;
+
+  /// The number of the mixture in the problem's list of mixtures of
+  /// each interval in the interval table, or -1 for a VOID interval.
+  static int *intvlMix;
 
   /// Library of Charged Particle Ranges
   static TempLibType rangeLib;
@@ -113,6 +153,14 @@ protected:
   /// Relationship between standard neutron energy groups, and the specLib
   /// neutron energy groups
   static int *energyRel;
+
+  /// The number of threads used to solve the intervals of a mixture
+  /// for each chain.
+  static int nThreads;
+
+  /// The number of intervals of a mixture solved together as a block
+  /// for each chain.
+  static int batchSize;
  
   /// This function is called by many of the constructors, as it sets up
   /// all the variables, particularly setting pointers to NULL and
@@ -171,6 +219,9 @@ public:
   /// cross-referencing.
   void addMixList(Volume *);
 
+  /// This function deletes the interval table.
+  static void deleteTable();
+
   /// This routine reads the flux from the filename specified in the
   /// first argument.
   void readFlux(char *, int, double);
@@ -182,11 +233,20 @@ public:
   /// This is the master routine for the creation of the reference flux.
   void refFlux(Volume*);
 
+  /// This function creates the table of reaction rates for the fluxes
+  /// of this mixture's list of intervals, or of this reference volume.
+  void makeRateTable();
+
   /// This is the master routine for the solution of the chain on the
   /// master schedule.
   void solve(Chain*, topSchedule*);
 
-  /// This is identical to solve(...) but does not perform the tallying.
+  /// This function collapses the rates of the chain with this
+  /// reference volume's flux, for solveRef(...).
+  void collapseRef(Chain*);
+
+  /// This is identical to solve(...) but does not perform the tallying,
+  /// and the rates must already have been collapsed by collapseRef(...).
   topScheduleT* solveRef(Chain*, topSchedule*);
 
   /// This short function supports the creation of the dump file.
@@ -217,8 +277,14 @@ public:
   /// not including the head of the list.
   int count();
 
-  /// This function reads values from a matrix of flux values.
-  void storeMatrix(double** fluxMatrix, double scale);
+  /// This function reads values from a matrix of flux values into
+  /// the flux slab, for the flux given in the last argument.
+  void storeMatrix(double** fluxMatrix, double scale, int fluxNum);
+
+  /// This function adds the number of fluxes given in the argument,
+  /// stored in the flux slab by storeMatrix(...), to the flux list of
+  /// each interval.
+  void linkFluxes(int);
 
   /// Calculate charged particle flux 
   void makeXFlux(Mixture *mixListHead);
@@ -246,6 +312,14 @@ public:
   /// Access function for energyRel
   static int* getEnergyRel() { return energyRel; };
 
+  /// Inline function sets the number of threads used by solve(...).
+  static void setNumThreads(int numThreads) { nThreads = numThreads; };
+  static int getNumThreads() { return nThreads; };
+
+  /// Inline function sets the number of intervals in each block solved
+  /// by solve(...).
+  static void setBatchSize(int numBatch) { batchSize = numBatch; };
+
   /// Write function for intervalptr
   void setintervalptr(int* pvalue) {intervalptr = pvalue;}; 
 };
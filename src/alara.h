@@ -70,6 +70,34 @@ public:
 #define MODE_FORWARD 1
 #define MODE_REVERSE 0
 
+#define SOLVER_ADAPTIVE 0
+#define SOLVER_CRAM16 16
+#define SOLVER_CRAM48 48
+
+/* the methods used to fill the elements of the transfer matrices,
+ * which also index the counts of each method */
+#define METHOD_ZERO 0
+#define METHOD_BATEMAN 1
+#define METHOD_EXPANSION 2
+#define METHOD_INVERSION 3
+#define METHOD_CRAM 4
+#define METHOD_REUSED 5
+#define NUMMETHODS 6
+/* an element classified for a loop solution, by either expansion or
+ * inversion */
+#define METHOD_LOOP NUMMETHODS
+
+/* paths of the triangular matrix products */
+#define TRIMULT_SCALAR 0
+#define TRIMULT_AVX2 1
+#define TRIMULT_AVX512 2
+
+/* powers of triangular matrices are found in closed form from this
+ * power up, when the error of each element is known to be within
+ * this tolerance */
+#define POWER_CLOSED_MIN 32
+#define POWER_TOLERANCE 1e-10
+
 #include "classes.h"
 
 #include "debug.h"
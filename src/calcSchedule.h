@@ -150,11 +150,24 @@ public:
   /// hierarchy passed in second argument.
   void setT(Chain*, calcScheduleT*);
 
+  /// This function does the same as setT(Chain*,calcScheduleT*) for
+  /// all the intervals of the block of intervals last collapsed by the
+  /// chain, given an array of their storage hierarchies.
+  void setT(Chain*, calcScheduleT**);
+
   /// In this fucntion each subschedule is solved recursively with
   /// master transfer matrix, 'calcScheduleT::opBlockT' being built by
   /// multiplication.
   void setSubTs(Chain*, calcScheduleT*);
 
+  /// This function does the same as setSubTs(Chain*,calcScheduleT*)
+  /// for a block of intervals.
+  void setSubTs(Chain*, calcScheduleT**);
+
+  /// This function returns the duration of this schedule, including
+  /// its pulsing history and final delay.
+  double duration();
+
   /// Inline function provides access to number of items in this schedule.
   int numItems() { return nItems; };
 
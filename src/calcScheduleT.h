@@ -67,6 +67,15 @@ public:
 
   /// Allows access to totalT
   Matrix& total() { return totalT;};
+
+  /// This function returns the number of bytes of storage held by the
+  /// transfer matrices of this whole hierarchy.
+  long storage();
+
+  /// This function deletes the storage of the transfer matrices of
+  /// this whole hierarchy, so that they must be found again from the
+  /// first rank of the next chain.
+  void release();
   
   /// Inline operator function provides C style indexing of 
   /// subschedule matrices.
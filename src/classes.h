@@ -18,6 +18,7 @@ class Zone;
 
 /* Chain */
 class Chain;
+class ChainTrie;
 class MixCompRef;
 class Node;
 class NuclearData;
@@ -28,7 +29,7 @@ class TreeInfo;
 class SinglePulse;
 class PulseHistory;
 class CacheData;
-class CacheListPtr;
+class DecayCache;
 class RateCache;
 class VolFlux;
 class calcSchedule;
@@ -46,10 +47,12 @@ class GammaSrc;
 /* DataLib */
 class DataLib;
 class ALARALib;
+class ALARA2Lib;
 class ASCIILib;
 class EAFLib;
 class ALARAJOYLib;
 
 /* Utility */
 class Matrix;
+class MatrixBatch;
 class Statistics;
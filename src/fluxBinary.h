@@ -0,0 +1,58 @@
+/* $Id$ */
+#ifndef FLUXBINARY_H
+#define FLUXBINARY_H
+
+#include <stdint.h>
+
+/* The binary flux format, written by tools/flux2bin and read by
+ * Flux::readBinary(...).
+ *
+ * A file starts with a header of FLUXBIN_HEADER_SIZE bytes, holding
+ * the structure below, followed by the fluxes of each interval, one
+ * after another, each of 'numGrps' values of 'dtype' bytes.  All the
+ * values are stored in the byte order of the machine that wrote them,
+ * which is recorded in 'byteOrder'.
+ *
+ * 'dataOffset' is the offset of the first interval from the start of
+ * the file, and 'volStride' the number of bytes from one interval to
+ * the next, so that the fluxes of interval 'volNum' start at byte
+ * dataOffset + volNum*volStride.  The data is aligned to
+ * FLUXBIN_ALIGN bytes, so that a file of double values with as many
+ * groups as the problem may be used in place once it is mapped into
+ * memory. */
+
+#define FLUXBIN_MAGIC "ALARAFLX"
+#define FLUXBIN_VERSION 1
+#define FLUXBIN_BYTE_ORDER 0x01020304
+#define FLUXBIN_HEADER_SIZE 64
+#define FLUXBIN_ALIGN 64
+
+struct FluxBinHeader
+{
+  /// FLUXBIN_MAGIC, without its terminating null.
+  char magic[8];
+
+  /// The version of the format, FLUXBIN_VERSION.
+  int32_t version;
+
+  /// FLUXBIN_BYTE_ORDER, as written by the machine that wrote the file.
+  int32_t byteOrder;
+
+  /// The size of each value: 4 for float and 8 for double.
+  int32_t dtype;
+
+  /// The number of groups of each interval.
+  int32_t numGrps;
+
+  /// The number of intervals.
+  int64_t numVols;
+
+  /// The offset of the first value from the start of the file.
+  int64_t dataOffset;
+
+  /// The number of bytes from the first value of one interval to the
+  /// first value of the next.
+  int64_t volStride;
+};
+
+#endif
@@ -15,14 +15,34 @@ double fact(int);
 
 double bateman(int,int,double*,double, int&);
 
-double dGn(int, double*, int*, int, int);
-double laplaceInverse(int, int, double*, double, int&);
+void dGn(int, double*, double*, int, int, double*, double*);
+double laplaceInverse(int, int, double*, double, int&, double*, double*);
 
 int smallExpansion(int,int,double*,double);
-double laplaceExpansion(int, int, double*, double, int&);
-
-
-double fillTElement(int, int, double*, double*, double, int*,int);
+double laplaceExpansion(int, int, double*, int&, double*, double*);
+
+
+void classifyRow(int, double*, double*, int, int*, int, unsigned char*,
+		 double*);
+void batemanPoles(int, double*, int, double, double*, double*);
+void batemanRow(int, int, int, int, const unsigned char*, double*, double*,
+		double*, double*);
+void fillTRow(int, const unsigned char*, double*, double*, int, double, int,
+	      double*, double*, double*, double*, long*);
+int rowWorkSize(int, int);
+
+/* cram.C */
+void cramExp(int, double*, double*, int, double, int, int, double*,
+	     double*);
+int cramWorkSize(int, int);
+
+/* triMult.C */
+void triMult(int, int, const double*, const double*, double*, double*);
+void triMultBatch(int, int, int, const double*, int, const double*, int,
+		  double*, double*);
+
+/* triPower.C */
+int triPower(int, int, int, const double*, double*, double*);
 
 
 /* output.C */
@@ -27,5 +27,6 @@ extern const char *tokenList;
 #define INTOK_IGNORE     23
 #define INTOK_REFFLUX    24
 #define INTOK_CPLIBS     25
+#define INTOK_SOLVER     26
 
 
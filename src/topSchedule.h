@@ -44,12 +44,20 @@ public:
   /// Overloaded assignment operator
   topSchedule& operator=(const topSchedule&);
 
+  /// This function returns the time from the start of the schedule
+  /// to the last cooling time.
+  double horizon();
+
   /// This function serves a similar purpose to
   /// calcSchedule::setDecay(...).
   void setDecay(Chain*);
 
   /// This function serves a similar purpose to calcSchedule::setT(...).
   void setT(Chain*, topScheduleT*);
+
+  /// This function serves a similar purpose to
+  /// calcSchedule::setT(Chain*,calcScheduleT**).
+  void setT(Chain*, topScheduleT**);
 };
 
 #endif
@@ -7,11 +7,25 @@
 #include "calcScheduleT.h"
 #include "Matrix.h"
 
+/* the number of counters given by getMemCounts(...): the peak storage
+ * and the number of hierarchies that released their storage */
+#define NUMMEMCOUNTS 2
+
 /** \brief This class is the head of a linked hierarchy of storage for
  *         the transfer matrices throughout the schedule.
  *
  *  This class is derived from calcScheduleT.  See its description for
  *  more details, particularly for inherited members and methods.
+ *
+ *  The transfer matrices of each interval are kept from one chain to
+ *  the next, so that only the rows of the isotopes that are new to a
+ *  chain need to be found.  When a memory budget is set, the storage
+ *  held by the hierarchies of the intervals is counted after each
+ *  interval, or block of intervals, is solved, and the intervals that
+ *  take it over the budget release their storage and from then on find
+ *  their whole transfer matrices again for each chain.  The rows of
+ *  the tables of reaction rates (see RateCache) are counted against
+ *  the same budget.
  */
 
 class topScheduleT : public calcScheduleT
@@ -22,9 +36,44 @@ protected:
   /// be stored.
   static int nCoolingTimes;
 
-  /// An array of Matrices for storing the results of the schedule
-  /// following the after-shutdown cooling times.
-  Matrix *coolT;
+  /// The length of each of the result vectors in 'coolT'.
+  int coolSize;
+
+  /// Storage for the results of the schedule following the
+  /// after-shutdown cooling times.
+  /** Only the elements of the cooling time transfer matrices that are
+      tallied by results(...) are ever needed, so for each cooling time
+      this stores a vector with one result for each rank of the chain,
+      the vector of cooling time 'coolNum' starting at
+      coolT[coolNum*coolSize]. */
+  double *coolT;
+
+  /// Storage for the list of results returned by results(...).
+  double *resultList;
+
+  /// The number of bytes of storage counted for this hierarchy by the
+  /// last call to account(...).
+  long stored;
+
+  /// A flag indicating whether this hierarchy keeps its storage from
+  /// one chain to the next.
+  int retained;
+
+  /// The memory budget for the storage of the hierarchies of the
+  /// intervals and of the tables of reaction rates, in bytes, or 0 if
+  /// it is not bounded.
+  static long memBudget;
+
+  /// The number of bytes of storage held by the hierarchies of the
+  /// intervals and by the tables of reaction rates.
+  static long memHeld;
+
+  /// The largest value of 'memHeld'.
+  static long memPeak;
+
+  /// The number of hierarchies which have released their storage to
+  /// stay within the budget.
+  static long nReleased;
 
 public:
   /// Inline function providing access to set static member
@@ -37,6 +86,44 @@ public:
   static int getNumCoolingTimes()
     { return nCoolingTimes; };
 
+  /// Inline function sets the memory budget, given in megabytes.
+  static void setMemBudget(double megabytes)
+    { memBudget = std::max(1L,(long)(megabytes*1048576)); };
+
+  /// Inline function queries whether the memory is bounded.
+  static int memBounded()
+    { return (memBudget > 0); };
+
+  /// This function counts the storage of the hierarchies given in the
+  /// first argument, of a block of the number of intervals given in the
+  /// second, which have just been solved, releasing it when needed to
+  /// stay within the memory budget.
+  static void account(topScheduleT**, int);
+
+  /// This function counts the number of bytes given in the argument,
+  /// which may be negative, as held by storage outside the
+  /// hierarchies, such as the tables of reaction rates.
+  static void hold(long);
+
+  /// This function queries whether the number of bytes given in the
+  /// argument would take the storage held over the memory budget.
+  static int overBudget(long);
+
+  /// This inline function copies the peak storage and the number of
+  /// hierarchies that released their storage into the argument.
+  static void getMemCounts(long *counts)
+    { counts[0] = memPeak; counts[1] = nReleased; };
+
+  /// This inline function adds the counters given in the argument, as
+  /// from getMemCounts(...), to those of the problem.
+  static void accountMemCounts(long *counts)
+    { memPeak += counts[0]; nReleased += counts[1]; };
+
+  /// This function reports the peak storage of the hierarchies of the
+  /// intervals and of the tables of reaction rates, if the memory is
+  /// bounded.
+  static void reportMem();
+
   
   /// Default constructor
   topScheduleT(topSchedule *top = NULL);
@@ -53,14 +140,33 @@ public:
   /// This function returns an array or results for the rank specified
   /// by the first argument, with one member of the array for each of
   /// the shutdown time and the various after-shutdown cooling times.
+  /** The array belongs to this object and is overwritten by the next
+      call. */
   double *results(int);
 
 
-  /// This funtion returns a reference to the Matrix class member of
-  /// array 'coolT' indicated by the argument.
+  /// Inline function queries whether this hierarchy keeps its storage
+  /// from one chain to the next.
+  int isRetained() { return retained; };
+
+  /// This function returns the number of bytes of storage held by
+  /// this whole hierarchy, including 'coolT'.
+  long storage();
+
+  /// This function deletes the storage of this whole hierarchy,
+  /// including 'coolT'.
+  void release();
+
+  /// This function makes sure that each result vector of 'coolT' has
+  /// room for the number of ranks given in the argument, keeping the
+  /// results already stored.
+  void resizeCool(int);
+
+  /// This funtion returns a pointer to the result vector of 'coolT'
+  /// for the cooling time indicated by the argument.
   /** With this function, we can avoid having friend classes and
       functions. */
-  Matrix& cool(int idx) { return coolT[idx]; };
+  double* cool(int idx) { return coolT+idx*coolSize; };
 };
 
 #endif